@@ -9,6 +9,9 @@
 #include <maya/MFnMesh.h>
 #include <maya/MFnIkJoint.h>
 #include <maya/MFnDagNode.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MPlug.h>
 #include <maya/MFnNurbsCurve.h>
 #include <maya/MFnNurbsCurveData.h>
 #include <maya/MFnNurbsCurveModifier.h>
@@ -170,6 +173,310 @@ MStatus InputCurveOptimizer::batchOptimizeCurves(const std::vector<MDagPath>& in
     return (successCount > 0) ? MS::kSuccess : MS::kFailure;
 }
 
+// 5. 점진적 LOD 계층 생성 (거친 레벨 → 세밀한 레벨, 한 번의 패스)
+// 세그먼트 분석은 한 번만 수행하고, 매 단계에서 오차가 가장 큰 위치에 편집점을 추가한다.
+// 중첩되는 것은 편집점 집합뿐이다. 각 레벨은 편집점을 chord-length 매개변수화로 다시
+// 보간하므로 knot 벡터는 레벨마다 새로 계산되며 레벨 간에 중첩되지 않는다.
+MStatus InputCurveOptimizer::buildProgressiveLODHierarchy(const MDagPath& inputCurvePath,
+                                                          const MString& outputPrefix,
+                                                          double maxCurvatureError,
+                                                          int numLevels)
+{
+    MStatus status;
+    
+    MFnNurbsCurve fnCurve(inputCurvePath, &status);
+    if (status != MS::kSuccess) return status;
+    
+    // 레벨 곡선은 양 끝점을 고정한 열린 곡선으로 보간하므로 닫힌/주기 곡선은 지원하지 않음
+    if (fnCurve.form() != MFnNurbsCurve::kOpen) {
+        MGlobal::displayError("LOD hierarchy supports open curves only: " + inputCurvePath.partialPathName());
+        return MS::kInvalidParameter;
+    }
+    
+    // 1단계: 곡률 기반 세분화 + 병합 (모든 레벨이 공유)
+    std::vector<CurveSegment> segments = subdivideByCurvature(inputCurvePath, maxCurvatureError);
+    if (segments.empty()) {
+        MGlobal::displayError("Failed to analyze curvature for LOD hierarchy");
+        return MS::kFailure;
+    }
+    mergeSimilarSegments(segments, maxCurvatureError);
+    
+    // 2단계: 정제 후보 매개변수와 원본 샘플점 준비
+    std::vector<double> candidateParams;
+    collectRefinementCandidates(fnCurve, segments, candidateParams);
+    
+    std::vector<MPoint> samplePoints(candidateParams.size());
+    for (size_t i = 0; i < candidateParams.size(); i++) {
+        fnCurve.getPointAtParam(candidateParams[i], samplePoints[i], MSpace::kWorld);
+    }
+    
+    // 레벨 오차 검증용 샘플 (후보 구간마다 촘촘하게, 편집점 위치와 겹치지 않도록)
+    const int validationSamplesPerInterval = 4;
+    std::vector<MPoint> validationPoints;
+    for (size_t i = 0; i + 1 < candidateParams.size(); i++) {
+        double intervalLength = candidateParams[i + 1] - candidateParams[i];
+        for (int j = 1; j <= validationSamplesPerInterval; j++) {
+            double paramU = candidateParams[i] + intervalLength * j / (validationSamplesPerInterval + 1);
+            MPoint point;
+            fnCurve.getPointAtParam(paramU, point, MSpace::kWorld);
+            validationPoints.push_back(point);
+        }
+    }
+    
+    // 3단계: 레벨별 목표 제어점 수 (3차 곡선 최소 4개 ~ mMaxControlPoints)
+    const int degree = 3;
+    const int minControlPoints = degree + 1;
+    int maxControlPoints = std::max(minControlPoints, mMaxControlPoints);
+    numLevels = std::max(1, numLevels);
+    
+    std::vector<int> targetControlPoints;
+    for (int level = 0; level < numLevels; level++) {
+        double t = (numLevels > 1) ? (double)level / (numLevels - 1) : 1.0;
+        int target = minControlPoints + (int)std::lround(t * (maxControlPoints - minControlPoints));
+        if (targetControlPoints.empty() || target > targetControlPoints.back()) {
+            targetControlPoints.push_back(target);
+        }
+    }
+    
+    // 4단계: 양 끝점에서 시작하여 점진적으로 편집점 추가 (씬은 아직 변경하지 않음)
+    // 편집점 n개 → 제어점 n + degree - 1개
+    std::vector<double> editParams;
+    editParams.push_back(candidateParams.front());
+    editParams.push_back(candidateParams.back());
+    
+    std::vector<CurveLODLevel> levels;
+    std::vector<std::vector<double> > levelEditParams;
+    
+    MFnNurbsCurveData dataCreator;
+    bool refinementExhausted = false;
+    
+    for (size_t level = 0; level < targetControlPoints.size(); level++) {
+        MObject tempCurve;
+        
+        while (true) {
+            // 중간 단계 곡선은 DAG에 추가하지 않고 곡선 데이터로만 생성
+            MObject curveData = dataCreator.create(&status);
+            if (status != MS::kSuccess) {
+                MGlobal::displayError("Failed to create curve data for LOD refinement");
+                return status;
+            }
+            
+            tempCurve = createCurveFromEditParams(fnCurve, editParams, curveData, &status);
+            if (status != MS::kSuccess) {
+                MGlobal::displayError("Failed to interpolate LOD curve with " + MString() +
+                                      (int)editParams.size() + " edit points");
+                return status;
+            }
+            
+            std::vector<double> sampleErrors;
+            status = measureSampleErrors(tempCurve, samplePoints, sampleErrors);
+            if (status != MS::kSuccess) {
+                MGlobal::displayError("Failed to measure LOD fit error");
+                return status;
+            }
+            
+            int currentControlPoints = (int)editParams.size() + degree - 1;
+            if (currentControlPoints >= targetControlPoints[level]) break;
+            
+            // 아직 편집점이 아닌 샘플 중 오차가 가장 큰 위치에 편집점 삽입
+            int insertIndex = -1;
+            for (size_t i = 0; i < sampleErrors.size(); i++) {
+                if (sampleErrors[i] <= 0.0) continue;
+                if (insertIndex >= 0 && sampleErrors[i] <= sampleErrors[insertIndex]) continue;
+                if (std::binary_search(editParams.begin(), editParams.end(), candidateParams[i])) continue;
+                insertIndex = (int)i;
+            }
+            if (insertIndex < 0) {
+                refinementExhausted = true;
+                break;
+            }
+            
+            double insertParam = candidateParams[insertIndex];
+            editParams.insert(std::lower_bound(editParams.begin(), editParams.end(), insertParam),
+                              insertParam);
+        }
+        
+        int levelControlPoints = (int)editParams.size() + degree - 1;
+        if (!levels.empty() && levelControlPoints <= levels.back().numControlPoints) {
+            // 모든 후보 샘플이 이미 편집점이거나 오차가 0이라 더 세밀한 레벨을 만들 수 없음
+            break;
+        }
+        
+        // 레벨 오차: 검증 샘플 → LOD 곡선, LOD 곡선 → 원본 양방향 최대 거리
+        double levelError = 0.0;
+        status = measureFitError(tempCurve, fnCurve, validationPoints,
+                                 (int)validationPoints.size(), levelError);
+        if (status != MS::kSuccess) {
+            MGlobal::displayError("Failed to measure LOD fit error");
+            return status;
+        }
+        
+        CurveLODLevel lodLevel;
+        lodLevel.level = (int)levels.size();
+        lodLevel.numControlPoints = levelControlPoints;
+        lodLevel.maxError = levelError;
+        levels.push_back(lodLevel);
+        levelEditParams.push_back(editParams);
+    }
+    
+    // 5단계: LOD 그룹과 레벨 곡선을 씬에 생성 (실패 시 생성한 노드 모두 삭제)
+    std::vector<MObject> createdNodes;
+    
+    MDagModifier dagModifier;
+    MObject groupObj = dagModifier.createNode("transform", MObject::kNullObj, &status);
+    if (status == MS::kSuccess) status = dagModifier.doIt();
+    if (status != MS::kSuccess) {
+        MGlobal::displayError("Failed to create LOD group");
+        return status;
+    }
+    createdNodes.push_back(groupObj);
+    
+    MFnDagNode groupNode(groupObj);
+    groupNode.setName(outputPrefix + "_lodGroup", false, &status);
+    if (status == MS::kSuccess) status = addLODAttribute(groupObj, "lodCount", "lodc", (int)levels.size());
+    
+    for (size_t i = 0; i < levels.size() && status == MS::kSuccess; i++) {
+        MObject parent = MObject::kNullObj;
+        MObject levelCurve = createCurveFromEditParams(fnCurve, levelEditParams[i], parent, &status);
+        if (status != MS::kSuccess) break;
+        createdNodes.push_back(levelCurve);
+        
+        MFnDagNode curveNode(levelCurve);
+        curveNode.setName(outputPrefix + "_lod" + MString() + levels[i].level, false, &status);
+        if (status != MS::kSuccess) break;
+        
+        MDagModifier reparentModifier;
+        status = reparentModifier.reparentNode(levelCurve, groupObj);
+        if (status == MS::kSuccess) status = reparentModifier.doIt();
+        if (status != MS::kSuccess) break;
+        
+        // 짧은 이름은 형제 노드 사이에서만 고유하므로 그룹 이동 후의 DAG 경로를 저장
+        levels[i].curveName = MDagPath::getAPathTo(levelCurve, &status).partialPathName();
+        if (status != MS::kSuccess) break;
+        
+        status = addLODAttribute(levelCurve, "lodLevel", "lodl", levels[i].level);
+        if (status == MS::kSuccess) status = addLODAttribute(levelCurve, "lodNumCVs", "lodn", levels[i].numControlPoints);
+        if (status == MS::kSuccess) status = addLODAttribute(levelCurve, "lodMaxError", "lode", levels[i].maxError);
+    }
+    
+    if (status != MS::kSuccess) {
+        MDagModifier cleanupModifier;
+        for (size_t i = createdNodes.size(); i-- > 0; ) {
+            cleanupModifier.deleteNode(createdNodes[i]);
+        }
+        MStatus cleanupStatus = cleanupModifier.doIt();
+        
+        if (cleanupStatus == MS::kSuccess) {
+            MGlobal::displayError("Failed to create LOD curves, partial hierarchy removed");
+        } else {
+            MGlobal::displayError("Failed to create LOD curves, and failed to remove partial hierarchy: " +
+                                  MString() + (int)createdNodes.size() + " nodes may remain under " +
+                                  groupNode.name());
+        }
+        return status;
+    }
+    
+    mLODHierarchy = levels;
+    mLODGroupPath = MDagPath::getAPathTo(groupObj);
+    
+    for (const CurveLODLevel& lodLevel : mLODHierarchy) {
+        MGlobal::displayInfo("LOD " + MString() + lodLevel.level + ": " + lodLevel.curveName +
+                             " (" + MString() + lodLevel.numControlPoints + " CVs, max error " +
+                             MString() + lodLevel.maxError + ")");
+    }
+    
+    if ((int)mLODHierarchy.size() < numLevels) {
+        MGlobal::displayWarning("Built " + MString() + (int)mLODHierarchy.size() + " of " +
+                                MString() + numLevels + " requested LOD levels" +
+                                MString(refinementExhausted ? " (refinement candidates exhausted)"
+                                                            : " (control point budget too small)"));
+    }
+    
+    MGlobal::displayInfo("Progressive LOD hierarchy built: " + inputCurvePath.partialPathName() +
+                         " -> " + mLODGroupPath.partialPathName() + " (" + MString() + (int)mLODHierarchy.size() + " levels)");
+    return MS::kSuccess;
+}
+
+const std::vector<CurveLODLevel>& InputCurveOptimizer::getLODHierarchy() const
+{
+    return mLODHierarchy;
+}
+
+const MDagPath& InputCurveOptimizer::getLODGroupPath() const
+{
+    return mLODGroupPath;
+}
+
+// 씬의 LOD 그룹 노드에 저장된 레벨 정보 읽기 (레벨 순으로 정렬)
+MStatus InputCurveOptimizer::readLODHierarchy(const MDagPath& lodGroupPath,
+                                              std::vector<CurveLODLevel>& levels)
+{
+    MStatus status;
+    levels.clear();
+    
+    MFnDagNode groupNode(lodGroupPath, &status);
+    if (status != MS::kSuccess) return status;
+    
+    for (unsigned int i = 0; i < groupNode.childCount(); i++) {
+        MObject childObj = groupNode.child(i);
+        MFnDagNode childNode(childObj);
+        if (!childNode.hasAttribute("lodLevel")) continue;
+        
+        MDagPath childPath = lodGroupPath;
+        status = childPath.push(childObj);
+        if (status != MS::kSuccess) return status;
+        
+        CurveLODLevel lodLevel;
+        lodLevel.level = childNode.findPlug("lodLevel", true).asInt();
+        lodLevel.numControlPoints = childNode.findPlug("lodNumCVs", true).asInt();
+        lodLevel.maxError = childNode.findPlug("lodMaxError", true).asDouble();
+        lodLevel.curveName = childPath.partialPathName();
+        levels.push_back(lodLevel);
+    }
+    
+    std::sort(levels.begin(), levels.end(),
+              [](const CurveLODLevel& a, const CurveLODLevel& b) { return a.level < b.level; });
+    
+    return levels.empty() ? MS::kFailure : MS::kSuccess;
+}
+
+// 제어점 예산 이하에서 가장 세밀한 레벨 선택 (없으면 -1)
+int InputCurveOptimizer::selectLODByControlPoints(const MDagPath& lodGroupPath,
+                                                  int maxControlPoints,
+                                                  MString* curveName)
+{
+    std::vector<CurveLODLevel> levels;
+    if (readLODHierarchy(lodGroupPath, levels) != MS::kSuccess) return -1;
+    
+    int selected = -1;
+    for (size_t i = 0; i < levels.size(); i++) {
+        if (levels[i].numControlPoints <= maxControlPoints) {
+            selected = (int)i;
+        }
+    }
+    if (selected < 0) return -1;
+    
+    if (curveName) *curveName = levels[selected].curveName;
+    return levels[selected].level;
+}
+
+// 오차 목표를 만족하는 가장 거친 레벨 선택 (없으면 -1)
+int InputCurveOptimizer::selectLODByError(const MDagPath& lodGroupPath,
+                                          double errorTarget,
+                                          MString* curveName)
+{
+    std::vector<CurveLODLevel> levels;
+    if (readLODHierarchy(lodGroupPath, levels) != MS::kSuccess) return -1;
+    
+    for (size_t i = 0; i < levels.size(); i++) {
+        if (levels[i].maxError <= errorTarget) {
+            if (curveName) *curveName = levels[i].curveName;
+            return levels[i].level;
+        }
+    }
+    return -1;
+}
+
 // === 🎨 특허 기반 최적화 옵션들 ===
 
 void InputCurveOptimizer::setOptimizationMode(bool useArcSegment)
@@ -324,12 +631,16 @@ std::vector<CurveSegment> InputCurveOptimizer::subdivideByCurvature(const MDagPa
     
     if (status != MS::kSuccess) return segments;
     
+    // 실제 knot domain 전체를 분석 (세그먼트 매개변수는 domain 기준 절대값)
+    double domainStart = 0.0, domainEnd = 1.0;
+    fnCurve.getKnotDomain(domainStart, domainEnd);
+    
     const int numSamples = 20;  // 곡선을 20개 구간으로 나누어 분석
-    double paramStep = 1.0 / numSamples;
+    double paramStep = (domainEnd - domainStart) / numSamples;
     
     for (int i = 0; i < numSamples; i++) {
-        double paramU = i * paramStep;
-        double nextParamU = (i + 1) * paramStep;
+        double paramU = domainStart + i * paramStep;
+        double nextParamU = domainStart + (i + 1) * paramStep;
         
         // 현재 구간의 곡률 분석
         MVector firstDerivative = fnCurve.tangent(paramU, MSpace::kWorld, &status);
@@ -337,8 +648,8 @@ std::vector<CurveSegment> InputCurveOptimizer::subdivideByCurvature(const MDagPa
         
         // 2차 미분 계산
         double delta = 1e-6;
-        double paramUPlus = std::min(1.0, paramU + delta);
-        double paramUMinus = std::max(0.0, paramU - delta);
+        double paramUPlus = std::min(domainEnd, paramU + delta);
+        double paramUMinus = std::max(domainStart, paramU - delta);
         
         MVector tangentPlus = fnCurve.tangent(paramUPlus, MSpace::kWorld);
         MVector tangentMinus = fnCurve.tangent(paramUMinus, MSpace::kWorld);
@@ -391,6 +702,8 @@ std::vector<CurveSegment> InputCurveOptimizer::subdivideByCurvature(const MDagPa
 void InputCurveOptimizer::mergeSimilarSegments(std::vector<CurveSegment>& segments,
                                               double maxCurvatureError)
 {
+    if (segments.empty()) return;
+    
     for (size_t i = 0; i < segments.size() - 1; ) {
         CurveSegment& current = segments[i];
         CurveSegment& next = segments[i + 1];
@@ -424,6 +737,164 @@ void InputCurveOptimizer::mergeSimilarSegments(std::vector<CurveSegment>& segmen
     }
 }
 
+// === 🪜 점진적 LOD 엔진 ===
+
+// 세그먼트 분석 결과로 정제 후보 매개변수 수집 (곡률이 큰 구간일수록 촘촘하게)
+void InputCurveOptimizer::collectRefinementCandidates(const MFnNurbsCurve& fnCurve,
+                                                      const std::vector<CurveSegment>& segments,
+                                                      std::vector<double>& candidateParams) const
+{
+    candidateParams.clear();
+    
+    double domainStart = 0.0, domainEnd = 1.0;
+    fnCurve.getKnotDomain(domainStart, domainEnd);
+    double domainLength = domainEnd - domainStart;
+    
+    // 기본 균등 샘플 (직선 구간에서도 최소한의 오차 측정 보장)
+    const int numBaseSamples = std::max(20, 2 * mMaxControlPoints);
+    for (int i = 0; i <= numBaseSamples; i++) {
+        candidateParams.push_back(domainStart + domainLength * i / numBaseSamples);
+    }
+    
+    // 곡선 세그먼트는 곡률에 비례해 추가 샘플 (세그먼트 매개변수는 knot domain 기준 절대값)
+    const int maxSamplesPerSegment = 16;
+    for (const CurveSegment& segment : segments) {
+        double startU = std::max(domainStart, std::min(domainEnd, segment.startParamU));
+        double endU = std::max(domainStart, std::min(domainEnd, segment.endParamU));
+        candidateParams.push_back(startU);
+        candidateParams.push_back(endU);
+        
+        if (segment.isLinear || mCurvatureThreshold <= 0.0) continue;
+        
+        int numSamples = (int)std::ceil(segment.curvatureMagnitude / mCurvatureThreshold);
+        numSamples = std::max(2, std::min(maxSamplesPerSegment, numSamples));
+        for (int i = 1; i < numSamples; i++) {
+            candidateParams.push_back(startU + (endU - startU) * i / numSamples);
+        }
+    }
+    
+    std::sort(candidateParams.begin(), candidateParams.end());
+    candidateParams.erase(std::unique(candidateParams.begin(), candidateParams.end()),
+                          candidateParams.end());
+}
+
+// 편집점 매개변수 집합으로 3차 곡선 생성 (parentOrOwner가 곡선 데이터면 DAG 밖에 생성)
+MObject InputCurveOptimizer::createCurveFromEditParams(const MFnNurbsCurve& fnSource,
+                                                       const std::vector<double>& editParams,
+                                                       MObject& parentOrOwner,
+                                                       MStatus* status)
+{
+    MPointArray editPoints;
+    for (double paramU : editParams) {
+        MPoint point;
+        fnSource.getPointAtParam(paramU, point, MSpace::kWorld);
+        editPoints.append(point);
+    }
+    
+    MFnNurbsCurve fnCurve;
+    return fnCurve.createWithEditPoints(editPoints, 3, MFnNurbsCurve::kOpen,
+                                        false, false, false, parentOrOwner, status);
+}
+
+// 원본 샘플점별로 LOD 곡선까지의 거리 측정 (정제 위치 선택용)
+MStatus InputCurveOptimizer::measureSampleErrors(const MObject& lodCurve,
+                                                 const std::vector<MPoint>& samplePoints,
+                                                 std::vector<double>& sampleErrors)
+{
+    sampleErrors.assign(samplePoints.size(), 0.0);
+    
+    MStatus status;
+    MFnNurbsCurve fnLod(lodCurve, &status);
+    if (status != MS::kSuccess) return status;
+    
+    for (size_t i = 0; i < samplePoints.size(); i++) {
+        MPoint closest = fnLod.closestPoint(samplePoints[i], NULL, 1e-6, MSpace::kObject, &status);
+        if (status != MS::kSuccess) return status;
+        sampleErrors[i] = closest.distanceTo(samplePoints[i]);
+    }
+    
+    return MS::kSuccess;
+}
+
+// 원본과 LOD 곡선 사이의 양방향 최대 거리 오차 측정
+// (검증 샘플 → LOD 곡선, 그리고 LOD 곡선 샘플 → 원본으로 보간 곡선의 오버슈트까지 검출)
+MStatus InputCurveOptimizer::measureFitError(const MObject& lodCurve,
+                                             const MFnNurbsCurve& fnSource,
+                                             const std::vector<MPoint>& validationPoints,
+                                             int numReverseSamples,
+                                             double& maxError)
+{
+    maxError = 0.0;
+    
+    std::vector<double> forwardErrors;
+    MStatus status = measureSampleErrors(lodCurve, validationPoints, forwardErrors);
+    if (status != MS::kSuccess) return status;
+    
+    for (double error : forwardErrors) {
+        maxError = std::max(maxError, error);
+    }
+    
+    MFnNurbsCurve fnLod(lodCurve, &status);
+    if (status != MS::kSuccess) return status;
+    
+    double domainStart = 0.0, domainEnd = 1.0;
+    status = fnLod.getKnotDomain(domainStart, domainEnd);
+    if (status != MS::kSuccess) return status;
+    
+    numReverseSamples = std::max(2, numReverseSamples);
+    for (int i = 0; i < numReverseSamples; i++) {
+        double paramU = domainStart + (domainEnd - domainStart) * i / (numReverseSamples - 1);
+        MPoint lodPoint;
+        status = fnLod.getPointAtParam(paramU, lodPoint, MSpace::kObject);
+        if (status != MS::kSuccess) return status;
+        
+        MPoint closest = fnSource.closestPoint(lodPoint, NULL, 1e-6, MSpace::kWorld, &status);
+        if (status != MS::kSuccess) return status;
+        maxError = std::max(maxError, closest.distanceTo(lodPoint));
+    }
+    
+    return MS::kSuccess;
+}
+
+// LOD 메타데이터를 노드의 동적 속성으로 저장 (디포머/뷰포트에서 조회)
+MStatus InputCurveOptimizer::addLODAttribute(MObject& node,
+                                             const MString& longName,
+                                             const MString& shortName,
+                                             int value)
+{
+    MStatus status;
+    MFnDependencyNode fnNode(node, &status);
+    if (status != MS::kSuccess) return status;
+    
+    MFnNumericAttribute fnAttr;
+    MObject attr = fnAttr.create(longName, shortName, MFnNumericData::kInt, value, &status);
+    if (status != MS::kSuccess) return status;
+    
+    status = fnNode.addAttribute(attr);
+    if (status != MS::kSuccess) return status;
+    
+    return fnNode.findPlug(longName, true).setValue(value);
+}
+
+MStatus InputCurveOptimizer::addLODAttribute(MObject& node,
+                                             const MString& longName,
+                                             const MString& shortName,
+                                             double value)
+{
+    MStatus status;
+    MFnDependencyNode fnNode(node, &status);
+    if (status != MS::kSuccess) return status;
+    
+    MFnNumericAttribute fnAttr;
+    MObject attr = fnAttr.create(longName, shortName, MFnNumericData::kDouble, value, &status);
+    if (status != MS::kSuccess) return status;
+    
+    status = fnNode.addAttribute(attr);
+    if (status != MS::kSuccess) return status;
+    
+    return fnNode.findPlug(longName, true).setValue(value);
+}
+
 // === 🏗️ 곡선 생성 엔진 ===
 
 // 메시에서 경로 추출
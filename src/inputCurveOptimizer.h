@@ -12,18 +12,29 @@
 #include <maya/MDagPath.h>
 #include <maya/MPoint.h>
 #include <maya/MVector.h>
+#include <maya/MObject.h>
 #include <vector>
 
+class MFnNurbsCurve;
+
 // 곡선 세그먼트 구조체
 struct CurveSegment {
-    double startParamU;           // 시작 매개변수
-    double endParamU;             // 끝 매개변수
+    double startParamU;           // 시작 매개변수 (knot domain 기준)
+    double endParamU;             // 끝 매개변수 (knot domain 기준)
     double curvatureMagnitude;    // 곡률 크기
     bool isLinear;                // 직선 여부
     double radius;                // 곡률 반지름
     MPoint center;                // 곡률 중심점
 };
 
+// 점진적 LOD 계층의 한 레벨
+struct CurveLODLevel {
+    int level;                    // 레벨 인덱스 (0 = 가장 거침)
+    int numControlPoints;         // 제어점 수
+    double maxError;              // 원본 곡선 대비 양방향 최대 거리 오차 (검증 샘플 기준)
+    MString curveName;            // 생성된 곡선의 고유한 DAG 경로 (partialPathName)
+};
+
 class InputCurveOptimizer {
 public:
     // 생성자/소멸자
@@ -53,6 +64,34 @@ public:
                                 const MString& outputPrefix,
                                 double maxCurvatureError = 0.01);
     
+    // 5. 점진적 LOD 계층 생성 (거친 레벨 → 세밀한 레벨, 한 번의 패스)
+    //    레벨 간에는 편집점 집합만 중첩되고 knot 벡터는 레벨마다 새로 계산된다.
+    //    열린 곡선만 지원 (닫힌/주기 곡선은 kInvalidParameter 반환).
+    //    <prefix>_lodGroup 아래에 <prefix>_lodN 곡선을 만들고 레벨 정보를 속성으로 저장
+    //    (lodLevel, lodNumCVs, lodMaxError). 이전 빌드의 곡선은 삭제하지 않고 유지된다.
+    MStatus buildProgressiveLODHierarchy(const MDagPath& inputCurvePath,
+                                         const MString& outputPrefix,
+                                         double maxCurvatureError = 0.01,
+                                         int numLevels = 4);
+    
+    // 마지막 buildProgressiveLODHierarchy 결과 조회 (곡선 DAG 경로, 그룹 경로)
+    const std::vector<CurveLODLevel>& getLODHierarchy() const;
+    const MDagPath& getLODGroupPath() const;
+    
+    // 씬의 LOD 그룹 노드에서 레벨 정보 읽기 (재계산 없음)
+    static MStatus readLODHierarchy(const MDagPath& lodGroupPath,
+                                    std::vector<CurveLODLevel>& levels);
+    
+    // 제어점 예산 이하에서 가장 세밀한 레벨 선택 (없으면 -1)
+    static int selectLODByControlPoints(const MDagPath& lodGroupPath,
+                                        int maxControlPoints,
+                                        MString* curveName = NULL);
+    
+    // 오차 목표를 만족하는 가장 거친 레벨 선택 (없으면 -1)
+    static int selectLODByError(const MDagPath& lodGroupPath,
+                                double errorTarget,
+                                MString* curveName = NULL);
+    
     // === 🎨 특허 기반 최적화 옵션들 ===
     
     // 최적화 모드 설정
@@ -93,6 +132,41 @@ private:
     void mergeSimilarSegments(std::vector<CurveSegment>& segments,
                              double maxCurvatureError);
     
+    // === 🪜 점진적 LOD 엔진 ===
+    
+    // 세그먼트 분석 결과로 정제 후보 매개변수 수집 (곡률이 큰 구간일수록 촘촘하게)
+    void collectRefinementCandidates(const MFnNurbsCurve& fnCurve,
+                                     const std::vector<CurveSegment>& segments,
+                                     std::vector<double>& candidateParams) const;
+    
+    // 편집점 매개변수 집합으로 3차 곡선 생성 (parentOrOwner가 곡선 데이터면 DAG 밖에 생성)
+    static MObject createCurveFromEditParams(const MFnNurbsCurve& fnSource,
+                                             const std::vector<double>& editParams,
+                                             MObject& parentOrOwner,
+                                             MStatus* status);
+    
+    // 원본 샘플점별로 LOD 곡선까지의 거리 측정 (정제 위치 선택용)
+    static MStatus measureSampleErrors(const MObject& lodCurve,
+                                       const std::vector<MPoint>& samplePoints,
+                                       std::vector<double>& sampleErrors);
+    
+    // 원본과 LOD 곡선 사이의 양방향 최대 거리 오차 측정 (레벨 오차로 기록)
+    static MStatus measureFitError(const MObject& lodCurve,
+                                   const MFnNurbsCurve& fnSource,
+                                   const std::vector<MPoint>& validationPoints,
+                                   int numReverseSamples,
+                                   double& maxError);
+    
+    // LOD 메타데이터를 노드의 동적 속성으로 저장
+    static MStatus addLODAttribute(MObject& node,
+                                   const MString& longName,
+                                   const MString& shortName,
+                                   int value);
+    static MStatus addLODAttribute(MObject& node,
+                                   const MString& longName,
+                                   const MString& shortName,
+                                   double value);
+    
     // === 🏗️ 곡선 생성 엔진 ===
     
     // 메시에서 경로 추출
@@ -113,6 +187,9 @@ private:
     double mCurvatureThreshold;       // 곡률 임계값 (0.001 ~ 0.1)
     int mMaxControlPoints;            // 최대 제어점 수 (5 ~ 50)
     bool mEnableKnotOptimization;     // Knot 분포 최적화 활성화
+    
+    std::vector<CurveLODLevel> mLODHierarchy;  // 마지막으로 생성된 LOD 계층
+    MDagPath mLODGroupPath;                    // 마지막으로 생성된 LOD 그룹 노드 경로
 };
 
 #endif // INPUT_CURVE_OPTIMIZER_H